@@ -1,11 +1,13 @@
 #include "musicplayer.h"
+#include "startuptimeline.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
+    StartupTimeline::start();
     QApplication a(argc, argv);
     MusicPlayer w;
-    w.show();
+    w.show();  // 媒体后端、背景和播放列表在首帧之后延迟初始化
     return a.exec();
 }
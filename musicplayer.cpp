@@ -1,42 +1,45 @@
 #include "musicplayer.h"
 #include "./ui_musicplayer.h"
+#include "startuptimeline.h"
 
 const QMediaMetaData MusicPlayer::MEDIA_METADATA_EMPTY = QMediaMetaData();
 MusicPlayer::MusicPlayer(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::MusicPlayer)
     , m_listModel(new QStandardItemModel)
-    , m_mediaPlayer(new QMediaPlayer(this))
-    , m_audioOutput(new QAudioOutput(this))
     , m_albumScene(new QGraphicsScene(this))
+    , m_scheduler(new TaskScheduler(this))
+    , m_seekTimer(new QTimer(this))
 
 {
+    // 构造函数只搭建界面，媒体后端、背景图片和播放列表在首帧绘制后再初始化
     ui->setupUi(this);
-    m_mediaPlayer->setAudioOutput(m_audioOutput);
     ui->musicListView->setModel(m_listModel);
     ui->albumView->setScene(m_albumScene);
-    m_currentBg.load(m_currentBgPath);
     initVolumeControl();
+    m_seekTimer->setSingleShot(true);
+    m_seekTimer->setInterval(SEEK_COALESCE_MS);
+    connect(m_seekTimer, &QTimer::timeout, this, &MusicPlayer::applyPendingSeek);
     connect(ui->playSlider, &QSlider::sliderMoved,this, &MusicPlayer::setPlayerPosition);
     connect(ui->playSlider, &QSlider::sliderPressed,this, &MusicPlayer::onSliderPressed);
     connect(ui->playSlider, &QSlider::sliderReleased,this, &MusicPlayer::onSliderReleased);
-    connect(m_mediaPlayer, &QMediaPlayer::durationChanged,this,&MusicPlayer::updateDuration);
-    connect(m_mediaPlayer, &QMediaPlayer::positionChanged,this, &MusicPlayer::updatePlayerPosition);
-    connect(m_mediaPlayer, &QMediaPlayer::playbackStateChanged, this, &MusicPlayer::handlePlaybackStateChanged);
-    connect(m_mediaPlayer, &QMediaPlayer::mediaStatusChanged, this, &MusicPlayer::handleMediaStatusChanged);
-    connect(m_mediaPlayer, &QMediaPlayer::metaDataChanged,this, &MusicPlayer::handleMetaDataChanged);
 
-    qApp->installEventFilter(this);  // 为整个应用安装事件过滤器
+    installEventFilter(this);              // 点击窗口空白处时隐藏音量滑块
     ui->volBtn->installEventFilter(this);  // 为音量按钮安装事件过滤器
-
-    loadMusicList();
-
+    // 窗口最小化启动或没有收到expose事件时不会绘制，超时后照常加载播放列表
+    QTimer::singleShot(DEFERRED_INIT_FALLBACK_MS, this, &MusicPlayer::scheduleDeferredInit);
+    StartupTimeline::mark("window constructed");
 }
 
 MusicPlayer::~MusicPlayer()
 {
-    // 保存配置
-    if (!defaultConfigPath.isEmpty())
+    m_trackToken.cancel();
+    m_folderToken.cancel();
+    m_prefetchToken.cancel();
+    m_scheduler->shutdown();
+    m_scheduler->logDiagnostics();
+    // 保存配置（列表尚未加载完成时不覆盖上次的配置）
+    if (m_playlistReady && !defaultConfigPath.isEmpty())
     {
         QFile config(defaultConfigPath);
         if (!config.open(QIODevice::WriteOnly|QIODevice::Text))
@@ -53,21 +56,17 @@ MusicPlayer::~MusicPlayer()
 
 void MusicPlayer::on_openDirBtn_clicked()
 {
+    resetFolderToken();  // 放弃尚未完成的目录加载
+    m_playlistReady = true;
     m_listModel->clear();
     auto musicPath = QFileDialog::getExistingDirectory(this,"选择文件夹（播放列表）",defaultMusicPath);
     m_currentMusicPath=musicPath;
     if (musicPath.isEmpty()){
         return;
     }
-    QDirIterator it_music(musicPath,{"*.mp3","*.wav","*.flac"});
-    while (it_music.hasNext()){
-        auto info = it_music.nextFileInfo();
-        auto item = new QStandardItem(info.fileName());
-        item->setData(it_music.fileInfo().canonicalFilePath());
-        m_listModel->appendRow(item);
-    }
     m_currentIndex = -1;
     ui->playBtn->setIcon(QIcon(":/Resources/play.svg")); // 恢复播放图标
+    submitMusicFolderScan(musicPath, [] {});
 }
 
 
@@ -124,7 +123,7 @@ void MusicPlayer::on_nextSongBtn_clicked()
     if (newIndex >= 0 && newIndex < totalSongs) {
         playTrack(newIndex);
     }
-    else {
+    else if (m_mediaPlayer) {
         m_mediaPlayer->pause();
     }
 }
@@ -135,6 +134,7 @@ void MusicPlayer::on_playBtn_clicked() {
         playTrack(0);
         return;
     }
+    initMediaBackend();
     switch (m_mediaPlayer->playbackState()) {
     case QMediaPlayer::PlayingState:
         m_mediaPlayer->pause();
@@ -194,6 +194,10 @@ void MusicPlayer::on_musicListView_doubleClicked(const QModelIndex &index) {
 
 void MusicPlayer::updateDuration(qint64 duration)
 {
+    // VBR MP3/FLAC的时长以索引扫描结果为准，进度条和歌词都使用真实时间
+    if (m_seekIndex.isValid()) {
+        duration = m_seekIndex.durationMs();
+    }
     ui->playSlider->setRange(0,static_cast<int>(duration));
     m_totalDurationTime = formatTime(duration);
     ui->durationLab->setText(m_totalDurationTime);
@@ -201,6 +205,8 @@ void MusicPlayer::updateDuration(qint64 duration)
 
 void MusicPlayer::updatePlayerPosition(qint64 position)
 {
+    // 换算到真实时间
+    position = qMax<qint64>(0, position + m_positionOffset);
     if (!m_isSliderMoving) {
         QSignalBlocker blocker(ui->playSlider);  // 改进的阻止信号方式
         ui->playSlider->setValue(static_cast<int>(position));
@@ -216,7 +222,34 @@ void MusicPlayer::updatePlayerPosition(qint64 position)
 }
 
 void MusicPlayer::setPlayerPosition(int position) {
-    m_mediaPlayer->setPosition(static_cast<qint64>(position));
+    // 拖动时只记录最新目标，由定时器合并后统一定位
+    m_pendingSeek = position;
+    if (!m_seekTimer->isActive()) {
+        m_seekTimer->start();
+    }
+}
+
+void MusicPlayer::applyPendingSeek()
+{
+    if (m_pendingSeek < 0 || !m_mediaPlayer) return;
+    qint64 target = m_pendingSeek;
+    m_pendingSeek = -1;
+    m_positionOffset = 0;
+    qint64 backendDuration = m_mediaPlayer->duration();
+    qint64 frameMs, byteOffset;
+    if (m_seekIndex.seeksByByteRatio() && backendDuration > 0
+        && m_seekIndex.locate(target, frameMs, byteOffset)) {
+        // 没有TOC的VBR MP3由后端按字节比例定位：换算出落在目标帧上的后端时间，
+        // 之后后端上报的位置加上偏移即为真实时间
+        qint64 backendTarget = byteOffset * backendDuration / m_seekIndex.fileSize();
+        m_positionOffset = frameMs - backendTarget;
+        m_mediaPlayer->setPosition(backendTarget);
+        return;
+    }
+    if (backendDuration > 0) {
+        target = qMin(target, backendDuration);
+    }
+    m_mediaPlayer->setPosition(target);
 }
 
 void MusicPlayer::onSliderPressed() {
@@ -225,7 +258,9 @@ void MusicPlayer::onSliderPressed() {
 
 void MusicPlayer::onSliderReleased() {
     m_isSliderMoving = false;
-    setPlayerPosition(ui->playSlider->value());
+    m_seekTimer->stop();
+    m_pendingSeek = ui->playSlider->value();
+    applyPendingSeek();
 }
 
 void MusicPlayer::handlePlaybackStateChanged(QMediaPlayer::PlaybackState state)
@@ -273,7 +308,7 @@ void MusicPlayer::handleMetaDataChanged()
     if (!coverVar.isNull() && coverVar.canConvert<QImage>()) {
         QImage img = coverVar.value<QImage>();
         if (!img.isNull()) {
-            displayAlbumArt(QPixmap::fromImage(img));
+            showAlbumArt(img);
             return;
         }
     }
@@ -281,7 +316,7 @@ void MusicPlayer::handleMetaDataChanged()
     if (!thumbVar.isNull() && thumbVar.canConvert<QImage>()) {
         QImage img = thumbVar.value<QImage>();
         if (!img.isNull()) {
-            displayAlbumArt(QPixmap::fromImage(img));
+            showAlbumArt(img);
             return;
         }
     }
@@ -292,7 +327,9 @@ void MusicPlayer::handleMetaDataChanged()
 void MusicPlayer::onVolumeSliderMoved(int value)
 {
     qreal volume = value / 100.0;
-    m_audioOutput->setVolume(volume);
+    if (m_audioOutput) {
+        m_audioOutput->setVolume(volume);
+    }
     if (value == 0 && !m_isMuted) {
         m_isMuted = true;
         ui->volBtn->setIcon(QIcon(":/Resources/mute.svg"));
@@ -331,6 +368,12 @@ void MusicPlayer::playTrack(int index)
     auto filePath = m_listModel->index(m_currentIndex, 0).data(Qt::UserRole+1).toString();
 
     if (!filePath.isEmpty()) {
+        initMediaBackend();
+        resetTrackToken();  // 上一首的歌词、封面、索引任务不再需要
+        m_seekTimer->stop();
+        m_pendingSeek = -1;
+        m_positionOffset = 0;
+        requestSeekIndex(filePath);
         QString path = QDir::toNativeSeparators(filePath);
         qDebug() << "Playing file:" << path;
         m_mediaPlayer->stop();
@@ -342,6 +385,7 @@ void MusicPlayer::playTrack(int index)
             modelIndex,
             QItemSelectionModel::ClearAndSelect
             );
+        prefetchNextTrack(index);
     }
 }
 
@@ -363,7 +407,6 @@ void MusicPlayer::initVolumeControl()
     m_volumeSlider->setRange(0, 100);
     m_volumeSlider->setValue(50);
     m_volumeSlider->setFixedSize(80, 20);
-    m_audioOutput->setVolume(0.5);
     ui->volBtn->setIcon(QIcon(":/Resources/volume.svg"));
     connect(m_volumeSlider, &QSlider::valueChanged, this, &MusicPlayer::onVolumeSliderMoved);
     ui->volBtn->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -375,14 +418,12 @@ void MusicPlayer::initVolumeControl()
 void MusicPlayer::toggleMute()
 {
     if (m_isMuted) {
-        // 恢复音量
-        m_audioOutput->setVolume(m_lastVolume / 100.0);
+        // 恢复音量（音频输出由滑块的valueChanged同步）
         m_volumeSlider->setValue(m_lastVolume);
         m_isMuted = false;
     } else {
         // 静音处理
         m_lastVolume = m_volumeSlider->value();  // 保存当前音量
-        m_audioOutput->setVolume(0.0);
         m_volumeSlider->setValue(0);
         m_isMuted = true;
     }
@@ -391,7 +432,7 @@ void MusicPlayer::toggleMute()
 
 void MusicPlayer::updateVolumeIcon()
 {
-    if (m_audioOutput->volume() == 0 || m_isMuted) {
+    if (m_volumeSlider->value() == 0 || m_isMuted) {
         ui->volBtn->setIcon(QIcon(":/Resources/mute.svg"));
     } else {
         ui->volBtn->setIcon(QIcon(":/Resources/volume.svg"));
@@ -400,9 +441,10 @@ void MusicPlayer::updateVolumeIcon()
 
 void MusicPlayer::displayAlbumArt(const QPixmap& pixmap)
 {
+    ++m_albumArtSerial;  // 之后送达的旧缩放结果不再覆盖
     m_albumScene->clear();
 
-    QSize viewSize = QSize(180,180);
+    QSize viewSize = QSize(ALBUM_ART_SIZE,ALBUM_ART_SIZE);
     QPixmap scaledPix = pixmap.scaled(
         viewSize,
         Qt::KeepAspectRatio,
@@ -424,63 +466,80 @@ void MusicPlayer::setNewBackground(const QString &path)
 void MusicPlayer::loadLyrics(const QString& musicFilePath) {
     m_currentLyrics.clear();
     lyricAvailable = false;
+    ui->lyricLab->clear();
+    ui->lyricLab->setToolTip(QString());
+
+    m_scheduler->submit(TaskScheduler::IoPool, TaskScheduler::CurrentTrack, m_trackToken,
+        [musicFilePath] { return parseLyrics(musicFilePath); },
+        [this](const QMap<qint64,QString> &lyrics) {
+            m_currentLyrics = lyrics;
+            lyricAvailable = !m_currentLyrics.isEmpty();
+            if (!lyricAvailable) {
+                ui->lyricLab->setText("找不到歌词喵");
+                ui->lyricLab->setToolTip("找不到歌词喵");
+            }
+        });
+}
+
+QMap<qint64,QString> MusicPlayer::parseLyrics(const QString& musicFilePath) {
+    QMap<qint64,QString> lyrics;
 
     // 获取同路径下同名的.lrc文件
     QString lyricPath = musicFilePath;
     lyricPath.replace(".mp3", ".lrc").replace(".flac", ".lrc").replace(".wav", ".lrc");
 
-    // 检查文件是否存在
+    // 打开并读取歌词文件，不存在或读取失败时返回空表
     QFile lyricFile(lyricPath);
-    if (!lyricFile.exists()) {
-        ui->lyricLab->setText("找不到歌词喵");
-        ui->lyricLab->setToolTip("找不到歌词喵");
-        return;
-    }
-
-    // 打开并读取歌词文件
-    if (lyricFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        // 默认UTF-8编码格式读取，如果为GBK等格式歌词显示会乱码
-        QTextStream in(&lyricFile);
-        // 解析歌词文件
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            // 匹配时间戳格式 [mm:ss.zzz] 或 [mm:ss]
-            static QRegularExpression timeRegex("\\[(\\d+):(\\d+)(?:\\.(\\d+))?\\]");
-            QRegularExpressionMatch match = timeRegex.match(line);
-
-            if (match.hasMatch()) {
-                int min = match.captured(1).toInt();
-                int sec = match.captured(2).toInt();
-                int msec = match.captured(3).isNull() ? 0 : match.captured(3).toInt();
-
-                // 计算总毫秒数
-                qint64 totalMs = min * 60000 + sec * 1000;
-                // 处理毫秒部分
-                if (match.captured(3).length() == 2) {
-                    msec *= 10;
-                } else if (match.captured(3).length() < 3 && msec < 100) {
-                    msec *= 10;
-                }
-                totalMs += msec;
+    if (!lyricFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return lyrics;
+    }
+    // 默认UTF-8编码格式读取，如果为GBK等格式歌词显示会乱码
+    QTextStream in(&lyricFile);
+    // 匹配时间戳格式 [mm:ss.zzz] 或 [mm:ss]（在工作线程中运行，不使用共享的静态对象）
+    QRegularExpression timeRegex("\\[(\\d+):(\\d+)(?:\\.(\\d+))?\\]");
+    // 解析歌词文件
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+        QRegularExpressionMatch match = timeRegex.match(line);
+
+        if (match.hasMatch()) {
+            int min = match.captured(1).toInt();
+            int sec = match.captured(2).toInt();
+            int msec = match.captured(3).isNull() ? 0 : match.captured(3).toInt();
+
+            // 计算总毫秒数
+            qint64 totalMs = min * 60000 + sec * 1000;
+            // 处理毫秒部分
+            if (match.captured(3).length() == 2) {
+                msec *= 10;
+            } else if (match.captured(3).length() < 3 && msec < 100) {
+                msec *= 10;
+            }
+            totalMs += msec;
 
-                // 提取歌词文本
-                QString lyricText = line.mid(match.capturedEnd());
-                if (!lyricText.isEmpty()) {
-                    m_currentLyrics[totalMs] = lyricText.trimmed();
-                }
+            // 提取歌词文本
+            QString lyricText = line.mid(match.capturedEnd());
+            if (!lyricText.isEmpty()) {
+                lyrics[totalMs] = lyricText.trimmed();
             }
         }
-        lyricFile.close();
-        lyricAvailable = !m_currentLyrics.isEmpty();
-    } else {
-        ui->lyricLab->setText("歌词文件读取失败");
-        ui->lyricLab->setToolTip("歌词文件读取失败");
     }
+    lyricFile.close();
+    return lyrics;
+}
 
-    if (!lyricAvailable) {
-        ui->lyricLab->setText("找不到歌词喵");
-        ui->lyricLab->setToolTip("找不到歌词喵");
-    }
+void MusicPlayer::showAlbumArt(const QImage &image)
+{
+    int serial = ++m_albumArtSerial;
+    m_scheduler->submit(TaskScheduler::CpuPool, TaskScheduler::CurrentTrack, m_trackToken,
+        [image] {
+            return image.scaled(QSize(ALBUM_ART_SIZE,ALBUM_ART_SIZE),
+                                Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        },
+        [this, serial](const QImage &scaled) {
+            if (serial != m_albumArtSerial) return;  // 已显示更新的封面
+            displayAlbumArt(QPixmap::fromImage(scaled));
+        });
 }
 
 QString MusicPlayer::findCurrentLyric(qint64 position) {
@@ -499,27 +558,224 @@ QString MusicPlayer::findCurrentLyric(qint64 position) {
 }
 
 void MusicPlayer::loadMusicList(){
-    if (!defaultConfigPath.isEmpty())
-    {
-        QFile config(defaultConfigPath);
-        if (!config.open(QIODevice::ReadOnly|QIODevice::Text))
-        {
-            return;
+    struct SavedList {
+        bool found = false;
+        QString path;
+        int index = -1;
+    };
+    // 配置文件在I/O线程读取
+    resetFolderToken();
+    QString configPath = defaultConfigPath;
+    m_scheduler->submit(TaskScheduler::IoPool, TaskScheduler::Background, m_folderToken,
+        [configPath] {
+            SavedList saved;
+            if (!configPath.isEmpty())
+            {
+                QFile config(configPath);
+                if (!config.open(QIODevice::ReadOnly|QIODevice::Text))
+                {
+                    return saved;
+                }
+                saved.path=config.readLine().trimmed();
+                saved.index=config.readLine().trimmed().toInt();
+                config.close();
+            }
+            saved.found = true;
+            return saved;
+        },
+        [this](const SavedList &saved) {
+            if (!saved.found) {
+                m_playlistReady = true;
+                checkPlayable();
+                return;
+            }
+            lastList = saved.path;
+            lastIndex = saved.index;
+            m_currentMusicPath = lastList;
+            submitMusicFolderScan(lastList, [this] { finishMusicListLoad(); });
+        });
+}
+
+void MusicPlayer::submitMusicFolderScan(const QString &path, std::function<void()> onFinished)
+{
+    // 遍历期间每批结果都经调度器送回GUI线程，列表边扫描边显示
+    TaskScheduler *scheduler = m_scheduler;
+    CancellationToken token = m_folderToken;
+    m_scheduler->submit(TaskScheduler::IoPool, TaskScheduler::Background, token,
+        [this, scheduler, token, path] {
+            scanMusicFolder(path, token, [this, scheduler, token](const MusicFolder &chunk) {
+                scheduler->post(token, [this, chunk] { appendMusicFolder(chunk); });
+            });
+            return true;
+        },
+        [onFinished](bool) { onFinished(); });
+}
+
+void MusicPlayer::scanMusicFolder(const QString &path, const CancellationToken &token,
+                                  const std::function<void(const MusicFolder &)> &emitChunk)
+{
+    MusicFolder folder;
+    QDirIterator it_music(path,{"*.mp3","*.wav","*.flac"});
+    while (it_music.hasNext() && !token.isCancelled()){
+        auto info = it_music.nextFileInfo();
+        folder.names.append(info.fileName());
+        folder.paths.append(info.canonicalFilePath());
+        if (folder.names.size() >= MUSIC_LIST_CHUNK) {
+            emitChunk(folder);
+            folder = MusicFolder();
         }
-        lastList=config.readLine().trimmed();
-        m_currentMusicPath=lastList;
-        lastIndex=config.readLine().trimmed().toInt();
-        config.close();
     }
-    QDirIterator it_music(lastList,{"*.mp3","*.wav","*.flac"});
-    while (it_music.hasNext()){
-        auto info = it_music.nextFileInfo();
-        auto item = new QStandardItem(info.fileName());
-        item->setData(it_music.fileInfo().canonicalFilePath());
-        m_listModel->appendRow(item);
+    if (!folder.names.isEmpty()) {
+        emitChunk(folder);
+    }
+}
+
+void MusicPlayer::appendMusicFolder(const MusicFolder &folder)
+{
+    QList<QStandardItem *> items;
+    items.reserve(folder.names.size());
+    for (int i = 0; i < folder.names.size(); ++i) {
+        auto item = new QStandardItem(folder.names[i]);
+        item->setData(folder.paths[i]);
+        items.append(item);
     }
-    m_currentIndex = lastIndex;
+    // 整批插入，每批只触发一次视图更新
+    m_listModel->invisibleRootItem()->appendRows(items);
+}
+
+void MusicPlayer::resetFolderToken()
+{
+    m_folderToken.cancel();
+    m_folderToken = CancellationToken();
+}
+
+void MusicPlayer::resetTrackToken()
+{
+    m_trackToken.cancel();
+    m_trackToken = CancellationToken();
+}
+
+void MusicPlayer::finishMusicListLoad()
+{
+    if (m_currentIndex < 0) {  // 加载期间用户已开始播放时不覆盖
+        m_currentIndex = lastIndex;
+    }
+    m_playlistReady = true;
     ui->playBtn->setIcon(QIcon(":/Resources/play.svg")); // 恢复播放图标
+    StartupTimeline::mark("playlist loaded");
+    checkPlayable();
+}
+
+void MusicPlayer::scheduleDeferredInit()
+{
+    if (m_deferredInitScheduled) return;
+    m_deferredInitScheduled = true;
+    QTimer::singleShot(0, this, &MusicPlayer::initDeferred);
+}
+
+void MusicPlayer::initDeferred()
+{
+    // 每个阶段单独占用一次事件循环，阶段之间界面仍可重绘和响应
+    loadBackgrounds();
+    QTimer::singleShot(0, this, [this] {
+        initMediaBackend();
+        QTimer::singleShot(0, this, &MusicPlayer::loadMusicList);
+    });
+}
+
+void MusicPlayer::loadBackgrounds()
+{
+    m_currentBg.load(m_currentBgPath);
+    m_defaultAlbum.load(":/Resources/defaultalbum.png");
+    update();
+    StartupTimeline::mark("backgrounds loaded");
+}
+
+void MusicPlayer::initMediaBackend()
+{
+    if (m_mediaPlayer) return;
+    m_mediaPlayer = new QMediaPlayer(this);
+    m_audioOutput = new QAudioOutput(this);
+    m_mediaPlayer->setAudioOutput(m_audioOutput);
+    m_audioOutput->setVolume(m_volumeSlider->value() / 100.0);
+    connect(m_mediaPlayer, &QMediaPlayer::durationChanged,this,&MusicPlayer::updateDuration);
+    connect(m_mediaPlayer, &QMediaPlayer::positionChanged,this, &MusicPlayer::updatePlayerPosition);
+    connect(m_mediaPlayer, &QMediaPlayer::playbackStateChanged, this, &MusicPlayer::handlePlaybackStateChanged);
+    connect(m_mediaPlayer, &QMediaPlayer::mediaStatusChanged, this, &MusicPlayer::handleMediaStatusChanged);
+    connect(m_mediaPlayer, &QMediaPlayer::metaDataChanged,this, &MusicPlayer::handleMetaDataChanged);
+    StartupTimeline::mark("media backend ready");
+    checkPlayable();
+}
+
+void MusicPlayer::checkPlayable()
+{
+    if (m_mediaPlayer && m_playlistReady) {
+        StartupTimeline::markPlayable();
+    }
+}
+
+void MusicPlayer::requestSeekIndex(const QString &filePath)
+{
+    // 上一首尚未完成的扫描已随曲目令牌一起取消
+    m_seekIndex = SeekIndex();
+    if (filePath == m_prefetchPath) {
+        if (m_prefetchStarted->load()) {
+            // 预取已在扫描这首歌：沿用它的令牌作为曲目令牌，结果送达时直接使用，避免重复扫描
+            m_trackToken = m_prefetchToken;
+            m_prefetchToken = CancellationToken();
+            m_prefetchPath.clear();
+            return;
+        }
+        // 预取仍在排队，优先级只是NextTrack：取消后按CurrentTrack重新提交
+        m_prefetchToken.cancel();
+        m_prefetchToken = CancellationToken();
+        m_prefetchPath.clear();
+    }
+    // 整个文件的扫描以读盘为主，放在I/O线程池
+    CancellationToken token = m_trackToken;
+    m_scheduler->submit(TaskScheduler::IoPool, TaskScheduler::CurrentTrack, token,
+        [filePath, token] { return SeekIndex::loadOrBuild(filePath, token.flag()); },
+        [this](const SeekIndex &index) { applySeekIndex(index); });
+}
+
+void MusicPlayer::applySeekIndex(const SeekIndex &index)
+{
+    if (!index.isValid()) return;
+    m_seekIndex = index;
+    if (m_mediaPlayer && m_mediaPlayer->duration() > 0) {
+        updateDuration(m_mediaPlayer->duration());
+    }
+}
+
+void MusicPlayer::prefetchNextTrack(int index)
+{
+    // 仅顺序播放时下一首可预知，索引写入磁盘缓存后切歌即可直接读取
+    int totalSongs = getPlaylistCount();
+    QString nextPath;
+    if (m_loopMode == LoopAll && totalSongs > 1) {
+        nextPath = m_listModel->index((index + 1) % totalSongs, 0).data(Qt::UserRole+1).toString();
+    }
+    if (!nextPath.isEmpty() && nextPath == m_prefetchPath) return;  // 同一首的预取仍在进行
+    // 下一首变了（或不再可预知）时取消旧的预取
+    m_prefetchToken.cancel();
+    m_prefetchToken = CancellationToken();
+    m_prefetchPath = nextPath;
+    if (nextPath.isEmpty()) return;
+    CancellationToken token = m_prefetchToken;
+    auto started = std::make_shared<std::atomic<bool>>(false);
+    m_prefetchStarted = started;
+    m_scheduler->submit(TaskScheduler::IoPool, TaskScheduler::NextTrack, token,
+        [nextPath, token, started] {
+            started->store(true);
+            return SeekIndex::loadOrBuild(nextPath, token.flag());
+        },
+        [this, nextPath](const SeekIndex &index) {
+            if (nextPath == m_prefetchPath) {
+                m_prefetchPath.clear();  // 仍是预取：结果已写入磁盘缓存
+            } else {
+                applySeekIndex(index);  // 已被当前曲目沿用
+            }
+        });
 }
 
 bool MusicPlayer::eventFilter(QObject *obj, QEvent *event)
@@ -549,19 +805,6 @@ bool MusicPlayer::eventFilter(QObject *obj, QEvent *event)
         }
         return false;
     }
-    if (m_volumeSlider && (obj == m_volumeSlider ||obj->parent() == m_volumeSlider))
-    {
-        switch (event->type())
-        {
-        case QEvent::MouseButtonPress:
-        case QEvent::MouseMove:
-        case QEvent::MouseButtonDblClick:
-        case QEvent::MouseButtonRelease:
-            return false;
-        default:
-            break;
-        }
-    }
     // 处理点击
     if (obj == this && event->type() == QEvent::MouseButtonPress)
     {
@@ -594,7 +837,15 @@ void MusicPlayer::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event);
     QPainter painter(this);
-    painter.drawPixmap(0, 0, width(), height(), m_currentBg);
+    // 背景图片尚未加载时由autoFillBackground的底色填充
+    if (!m_currentBg.isNull()) {
+        painter.drawPixmap(0, 0, width(), height(), m_currentBg);
+    }
+    if (!m_firstFrameShown) {
+        m_firstFrameShown = true;
+        StartupTimeline::markFirstFrame();
+        scheduleDeferredInit();
+    }
 }
 
 
@@ -17,6 +17,9 @@
 #include <QPainter>
 #include <QFile>
 #include <QSlider>
+#include <QTimer>
+#include "seekindex.h"
+#include "taskscheduler.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -54,6 +57,7 @@ private slots:
     void setPlayerPosition(int position);
     void onSliderPressed();
     void onSliderReleased();
+    void applyPendingSeek();                        // 执行拖动期间最新的定位请求
 
     // 状态相关
     void handleMediaStatusChanged(QMediaPlayer::MediaStatus status);
@@ -74,9 +78,32 @@ private:
     void updateVolumeIcon();                        // 更新音量图标
     void displayAlbumArt(const QPixmap& pixmap);    // 显示封面
     void setNewBackground(const QString &path);
-    void loadLyrics(const QString& musicFilePath);  // 加载歌词文件
+    void loadLyrics(const QString& musicFilePath);  // 在后台加载歌词文件
+    static QMap<qint64,QString> parseLyrics(const QString& musicFilePath);
+    void showAlbumArt(const QImage &image);         // 在后台缩放封面后显示
     QString findCurrentLyric(qint64 position);      // 根据时间位置找歌词
     void loadMusicList();
+    void finishMusicListLoad();
+    struct MusicFolder {
+        QStringList names;
+        QStringList paths;
+    };
+    static constexpr int MUSIC_LIST_CHUNK = 256;    // 遍历目录时每批送回的歌曲数
+    // 在I/O线程遍历目录，每凑满一批就交给emitChunk；令牌失效时提前结束
+    static void scanMusicFolder(const QString &path, const CancellationToken &token,
+                                const std::function<void(const MusicFolder &)> &emitChunk);
+    void submitMusicFolderScan(const QString &path, std::function<void()> onFinished);
+    void appendMusicFolder(const MusicFolder &folder);
+    void resetFolderToken();                        // 作废属于旧目录的后台任务
+    void resetTrackToken();                         // 作废属于旧曲目的后台任务
+    void prefetchNextTrack(int index);              // 提前为下一首建立定位索引
+    void applySeekIndex(const SeekIndex &index);
+    void scheduleDeferredInit();                    // 安排延迟初始化（只执行一次）
+    void initDeferred();                            // 首帧之后的延迟初始化入口
+    void loadBackgrounds();                         // 加载背景和默认封面
+    void initMediaBackend();                        // 按需创建播放器和音频输出
+    void checkPlayable();                           // 后端和列表都就绪后记录可播放时间
+    void requestSeekIndex(const QString &filePath); // 在后台线程读取或建立定位索引
 
     Ui::MusicPlayer *ui;
     QStandardItemModel *m_listModel;
@@ -92,7 +119,7 @@ private:
     bool m_isMuted = false;                   // 当前是否处于静音状态
     static const QMediaMetaData MEDIA_METADATA_EMPTY; // 空元数据常量
     QGraphicsScene *m_albumScene;             // 封面场景对象
-    QPixmap m_defaultAlbum= QPixmap(":/Resources/defaultalbum.png");                   // 默认封面图片
+    QPixmap m_defaultAlbum;                   // 默认封面图片（首帧后加载）
     bool lightmode=true;
     QString m_currentBgPath = ":/Resources/lightmodebackground.png";                   // 存储当前背景图片路径
     QPixmap m_currentBg;
@@ -103,6 +130,23 @@ private:
     int lastIndex;
     QString defaultMusicPath="./Music";
     QString defaultConfigPath="./config.txt";
+    bool m_firstFrameShown = false;
+    bool m_deferredInitScheduled = false;
+    static constexpr int DEFERRED_INIT_FALLBACK_MS = 500; // 窗口迟迟没有绘制时的兜底延时
+    bool m_playlistReady = false;             // 播放列表是否加载完成
+    SeekIndex m_seekIndex;                    // 当前曲目的定位索引
+    qint64 m_positionOffset = 0;              // 后端上报位置与真实时间之差（按字节比例定位后产生）
+    TaskScheduler *m_scheduler;               // 后台任务调度器
+    CancellationToken m_trackToken;           // 切换曲目时作废
+    CancellationToken m_folderToken;          // 切换目录时作废
+    CancellationToken m_prefetchToken;        // 下一首预取的令牌，开始播放该曲时并入曲目令牌
+    QString m_prefetchPath;                   // 正在预取的文件
+    std::shared_ptr<std::atomic<bool>> m_prefetchStarted; // 预取任务是否已开始执行
+    int m_albumArtSerial = 0;                 // 丢弃过期的封面缩放结果
+    static constexpr int ALBUM_ART_SIZE = 180;
+    QTimer *m_seekTimer;                      // 合并拖动进度条时的定位请求
+    qint64 m_pendingSeek = -1;
+    static constexpr int SEEK_COALESCE_MS = 40;
 
 protected:
     bool eventFilter(QObject *obj, QEvent *event) override;
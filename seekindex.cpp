@@ -0,0 +1,422 @@
+#include "seekindex.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cstring>
+
+namespace {
+
+const quint32 CACHE_MAGIC = 0x4D505349;  // "MPSI"
+const quint32 CACHE_VERSION = 2;
+const qint64 CANCEL_CHECK_BYTES = 64 * 1024;  // 扫描时每隔多少字节检查一次取消
+const qint64 ID3V1_SIZE = 128;
+const qint64 READ_CHUNK_BYTES = 1024 * 1024;  // 无法内存映射时每次读入的字节数
+
+bool isCancelled(const std::atomic<bool> *cancel)
+{
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+// MPEG音频帧头
+struct Mp3Frame {
+    quint32 sampleRate;
+    quint32 samples;
+    qint64 length;
+};
+
+bool parseMp3Header(const uchar *p, Mp3Frame &frame)
+{
+    static const int bitrates[2][3][16] = {
+        {   // MPEG1: Layer I, II, III
+            {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0},
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 0},
+            {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0},
+        },
+        {   // MPEG2/2.5: Layer I, II, III
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},
+        },
+    };
+    static const int sampleRates[3] = {44100, 48000, 32000};
+
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) return false;
+    int version = (p[1] >> 3) & 3;      // 0: 2.5, 1: 保留, 2: 2, 3: 1
+    int layer = 4 - ((p[1] >> 1) & 3);  // 1..3，4表示保留
+    int bitrateIndex = p[2] >> 4;
+    int rateIndex = (p[2] >> 2) & 3;
+    int padding = (p[2] >> 1) & 1;
+    if (version == 1 || layer == 4 || bitrateIndex == 0 || bitrateIndex == 15 || rateIndex == 3) {
+        return false;
+    }
+    bool mpeg1 = version == 3;
+    qint64 bitrate = bitrates[mpeg1 ? 0 : 1][layer - 1][bitrateIndex] * 1000;
+    frame.sampleRate = sampleRates[rateIndex] >> (mpeg1 ? 0 : (version == 2 ? 1 : 2));
+    if (layer == 1) {
+        frame.samples = 384;
+        frame.length = (12 * bitrate / frame.sampleRate + padding) * 4;
+    } else if (layer == 2 || mpeg1) {
+        frame.samples = 1152;
+        frame.length = 144 * bitrate / frame.sampleRate + padding;
+    } else {
+        frame.samples = 576;
+        frame.length = 72 * bitrate / frame.sampleRate + padding;
+    }
+    return frame.length > 4;
+}
+
+quint32 readBigEndian32(const uchar *p)
+{
+    return quint32(p[0]) << 24 | quint32(p[1]) << 16 | quint32(p[2]) << 8 | p[3];
+}
+
+quint8 crc8(const uchar *p, qint64 size)
+{
+    quint8 crc = 0;
+    for (qint64 i = 0; i < size; ++i) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80) ? static_cast<quint8>((crc << 1) ^ 0x07) : static_cast<quint8>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// 解析FLAC帧头，成功时返回帧起始采样位置和该帧采样数
+bool parseFlacHeader(const uchar *p, qint64 available, quint32 streamBlockSize,
+                     qint64 &sample, quint32 &blockSize)
+{
+    if (available < 6 || p[0] != 0xFF || (p[1] & 0xFE) != 0xF8) return false;
+    bool variable = p[1] & 1;
+    int blockCode = p[2] >> 4;
+    int rateCode = p[2] & 0x0F;
+    if (blockCode == 0 || rateCode == 15 || (p[3] >> 4) >= 11 || ((p[3] >> 1) & 7) == 3
+        || ((p[3] >> 1) & 7) == 7 || (p[3] & 1)) {
+        return false;
+    }
+
+    // UTF-8风格编码的帧号（定长块）或采样号（变长块）
+    qint64 pos = 4;
+    int extra = 0;
+    quint64 number = p[pos];
+    if (number >= 0x80) {
+        if (number == 0xFE) { extra = 6; number = 0; }
+        else if (number >= 0xFC) { extra = 5; number &= 0x01; }
+        else if (number >= 0xF8) { extra = 4; number &= 0x03; }
+        else if (number >= 0xF0) { extra = 3; number &= 0x07; }
+        else if (number >= 0xE0) { extra = 2; number &= 0x0F; }
+        else if (number >= 0xC0) { extra = 1; number &= 0x1F; }
+        else return false;
+    }
+    ++pos;
+    if (pos + extra > available) return false;
+    for (int i = 0; i < extra; ++i, ++pos) {
+        if ((p[pos] & 0xC0) != 0x80) return false;
+        number = (number << 6) | (p[pos] & 0x3F);
+    }
+
+    if (blockCode == 1) {
+        blockSize = 192;
+    } else if (blockCode <= 5) {
+        blockSize = 576u << (blockCode - 2);
+    } else if (blockCode == 6) {
+        if (pos + 1 > available) return false;
+        blockSize = p[pos] + 1;
+        pos += 1;
+    } else if (blockCode == 7) {
+        if (pos + 2 > available) return false;
+        blockSize = ((p[pos] << 8) | p[pos + 1]) + 1;
+        pos += 2;
+    } else {
+        blockSize = 256u << (blockCode - 8);
+    }
+    if (rateCode == 12) pos += 1;
+    else if (rateCode == 13 || rateCode == 14) pos += 2;
+    if (pos + 1 > available || crc8(p, pos) != p[pos]) return false;
+
+    sample = variable ? static_cast<qint64>(number) : static_cast<qint64>(number) * streamBlockSize;
+    return true;
+}
+
+} // namespace
+
+SeekIndex SeekIndex::loadOrBuild(const QString &filePath, const std::atomic<bool> *cancel)
+{
+    SeekIndex index = loadCache(filePath);
+    if (index.isValid()) return index;
+    index = build(filePath, cancel);
+    if (index.isValid()) {
+        index.saveCache(filePath);
+    }
+    return index;
+}
+
+qint64 SeekIndex::durationMs() const
+{
+    if (!isValid()) return 0;
+    return m_totalSamples * 1000 / m_sampleRate;
+}
+
+bool SeekIndex::locate(qint64 ms, qint64 &frameMs, qint64 &byteOffset) const
+{
+    if (m_entries.isEmpty() || m_fileSize <= 0) return false;
+    qint64 k = qBound<qint64>(0, ms * m_sampleRate / 1000 / m_intervalSamples, m_entries.size() - 1);
+    const Entry &entry = m_entries[k];
+    frameMs = entry.sample * 1000 / m_sampleRate;
+    byteOffset = entry.byteOffset;
+    return true;
+}
+
+SeekIndex SeekIndex::build(const QString &filePath, const std::atomic<bool> *cancel)
+{
+    SeekIndex index;
+    QString suffix = QFileInfo(filePath).suffix().toLower();
+    if (suffix != "mp3" && suffix != "flac") return index;  // WAV等PCM格式本身可以准确定位
+    if (isCancelled(cancel)) return index;
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return index;
+
+    // 优先内存映射，映射失败时分块读入，每块之间检查取消
+    QByteArray buffer;
+    const uchar *data = file.map(0, file.size());
+    qint64 size = file.size();
+    if (!data) {
+        buffer.reserve(size);
+        while (!file.atEnd()) {
+            if (isCancelled(cancel)) return index;
+            QByteArray chunk = file.read(READ_CHUNK_BYTES);
+            if (chunk.isEmpty()) break;
+            buffer.append(chunk);
+        }
+        data = reinterpret_cast<const uchar *>(buffer.constData());
+        size = buffer.size();
+    }
+    index.m_fileSize = size;
+    bool ok = suffix == "mp3" ? index.scanMp3(data, size, cancel)
+                              : index.scanFlac(data, size, cancel);
+    if (!ok || isCancelled(cancel)) {
+        return SeekIndex();
+    }
+    return index;
+}
+
+SeekIndex SeekIndex::loadCache(const QString &filePath)
+{
+    SeekIndex index;
+    QFileInfo info(filePath);
+    QFile cache(cachePath(filePath));
+    if (!info.exists() || !cache.open(QIODevice::ReadOnly)) return index;
+
+    QDataStream in(&cache);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0;
+    qint64 modified = 0;
+    qint32 count = 0;
+    in >> magic >> version >> index.m_fileSize >> modified;
+    if (in.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != CACHE_VERSION
+        || index.m_fileSize != info.size() || modified != info.lastModified().toMSecsSinceEpoch()) {
+        return SeekIndex();
+    }
+    in >> index.m_sampleRate >> index.m_intervalSamples >> index.m_totalSamples >> count;
+    // 缓存文件可能损坏或被截断，条目数必须与剩余字节数相符
+    const qint64 entryBytes = 2 * sizeof(qint64);
+    if (in.status() != QDataStream::Ok || index.m_sampleRate == 0 || index.m_intervalSamples <= 0
+        || index.m_totalSamples <= 0 || count < 0 || count * entryBytes > cache.size() - cache.pos()) {
+        return SeekIndex();
+    }
+    index.m_entries.resize(count);
+    for (Entry &entry : index.m_entries) {
+        in >> entry.sample >> entry.byteOffset;
+    }
+    if (in.status() != QDataStream::Ok) return SeekIndex();
+    return index;
+}
+
+bool SeekIndex::saveCache(const QString &filePath) const
+{
+    QString path = cachePath(filePath);
+    if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).absolutePath())) return false;
+
+    QFileInfo info(filePath);
+    QSaveFile cache(path);
+    if (!cache.open(QIODevice::WriteOnly)) return false;
+    QDataStream out(&cache);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << CACHE_MAGIC << CACHE_VERSION << m_fileSize << info.lastModified().toMSecsSinceEpoch()
+        << m_sampleRate << m_intervalSamples << m_totalSamples
+        << static_cast<qint32>(m_entries.size());
+    for (const Entry &entry : m_entries) {
+        out << entry.sample << entry.byteOffset;
+    }
+    return cache.commit();
+}
+
+QString SeekIndex::cachePath(const QString &filePath)
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty()) return QString();
+    QByteArray key = QCryptographicHash::hash(QFileInfo(filePath).absoluteFilePath().toUtf8(),
+                                              QCryptographicHash::Sha1).toHex();
+    return dir + "/seekindex/" + QString::fromLatin1(key) + ".idx";
+}
+
+bool SeekIndex::scanMp3(const uchar *data, qint64 size, const std::atomic<bool> *cancel)
+{
+    qint64 pos = 0;
+    // 跳过ID3v2标签
+    while (pos + 10 <= size && data[pos] == 'I' && data[pos + 1] == 'D' && data[pos + 2] == '3') {
+        qint64 tagSize = (data[pos + 6] & 0x7F) << 21 | (data[pos + 7] & 0x7F) << 14
+                         | (data[pos + 8] & 0x7F) << 7 | (data[pos + 9] & 0x7F);
+        pos += 10 + tagSize + ((data[pos + 5] & 0x10) ? 10 : 0);
+    }
+    // 文件末尾的ID3v1标签不参与扫描
+    qint64 end = size;
+    if (size - ID3V1_SIZE >= pos && !memcmp(data + size - ID3V1_SIZE, "TAG", 3)) {
+        end = size - ID3V1_SIZE;
+    }
+
+    qint64 sample = 0;
+    qint64 nextCheck = pos;
+    qint64 xingFrames = -1;
+    bool hasToc = false;
+    bool locked = false;
+    bool first = true;
+    while (pos + 4 <= end) {
+        if (pos >= nextCheck) {
+            if (isCancelled(cancel)) return false;
+            nextCheck = pos + CANCEL_CHECK_BYTES;
+        }
+
+        Mp3Frame frame;
+        if (!parseMp3Header(data + pos, frame)
+            || (m_sampleRate != 0 && frame.sampleRate != m_sampleRate)) {
+            locked = false;
+            ++pos;
+            continue;
+        }
+        // 重新同步时要求下一帧帧头也有效，避免把音频数据误认为帧头
+        if (!locked) {
+            Mp3Frame next;
+            qint64 nextPos = pos + frame.length;
+            if (nextPos + 4 <= end && !parseMp3Header(data + nextPos, next)) {
+                ++pos;
+                continue;
+            }
+            locked = true;
+        }
+        if (m_sampleRate == 0) {
+            m_sampleRate = frame.sampleRate;
+            m_intervalSamples = qMax<qint64>(1, m_sampleRate * INTERVAL_MS / 1000);
+        }
+        // 首帧若为Xing/Info信息帧则不含音频
+        if (first) {
+            first = false;
+            qint64 headSize = qMin<qint64>(frame.length, end - pos);
+            const uchar *head = data + pos;
+            const uchar *tag = nullptr;
+            for (qint64 i = 4; i + 8 <= headSize && i < 64; ++i) {
+                if (!memcmp(head + i, "Xing", 4) || !memcmp(head + i, "Info", 4)) {
+                    tag = head + i;
+                    break;
+                }
+            }
+            if (tag) {
+                quint32 flags = readBigEndian32(tag + 4);
+                if ((flags & 1) && tag + 12 <= head + headSize) {
+                    xingFrames = readBigEndian32(tag + 8);
+                }
+                hasToc = flags & 4;
+                // 带TOC时后端按TOC定位，只需要帧数给出的时长
+                if (hasToc && xingFrames > 0) {
+                    m_totalSamples = xingFrames * frame.samples;
+                    return true;
+                }
+                pos += frame.length;
+                continue;
+            }
+        }
+        if (!hasToc) {
+            addFrame(sample, frame.samples, pos);
+        }
+        sample += frame.samples;
+        pos += frame.length;
+    }
+    m_totalSamples = sample;
+    return isValid();
+}
+
+bool SeekIndex::scanFlac(const uchar *data, qint64 size, const std::atomic<bool> *cancel)
+{
+    if (size < 4 || memcmp(data, "fLaC", 4) != 0) return false;
+
+    // 元数据块，STREAMINFO为第一个块
+    qint64 pos = 4;
+    quint32 minBlock = 0;
+    qint64 streamSamples = 0;
+    bool last = false;
+    while (!last && pos + 4 <= size) {
+        last = data[pos] & 0x80;
+        int type = data[pos] & 0x7F;
+        qint64 length = data[pos + 1] << 16 | data[pos + 2] << 8 | data[pos + 3];
+        pos += 4;
+        if (pos + length > size) return false;
+        if (type == 0 && length >= 18) {
+            const uchar *s = data + pos;
+            minBlock = s[0] << 8 | s[1];
+            m_sampleRate = s[10] << 12 | s[11] << 4 | s[12] >> 4;
+            streamSamples = static_cast<qint64>(s[13] & 0x0F) << 32
+                            | static_cast<qint64>(s[14]) << 24 | s[15] << 16 | s[16] << 8 | s[17];
+        }
+        pos += length;
+    }
+    if (m_sampleRate == 0 || minBlock == 0) return false;
+    // FLAC由后端按帧头时间戳二分定位，本身准确，只需要准确时长
+    // STREAMINFO记录了总采样数时无需扫描音频帧
+    if (streamSamples > 0) {
+        m_totalSamples = streamSamples;
+        return true;
+    }
+
+    qint64 end = 0;
+    qint64 nextCheck = pos;
+    while (pos + 2 <= size) {
+        if (pos >= nextCheck) {
+            if (isCancelled(cancel)) return false;
+            nextCheck = pos + CANCEL_CHECK_BYTES;
+        }
+        // 每次最多查找到下一个检查点，保证长时间没有同步码时也能响应取消
+        qint64 window = qMin(size, nextCheck) - pos;
+        const void *hit = memchr(data + pos, 0xFF, static_cast<size_t>(window));
+        if (!hit) {
+            pos += window;
+            continue;
+        }
+        pos = static_cast<const uchar *>(hit) - data;
+        qint64 sample;
+        quint32 blockSize;
+        // 帧必须紧接上一帧结束位置，过滤音频数据中偶然出现的同步码
+        if (parseFlacHeader(data + pos, size - pos, minBlock, sample, blockSize) && sample == end) {
+            end = sample + blockSize;
+            pos += 6;
+        } else {
+            ++pos;
+        }
+    }
+    m_totalSamples = end;
+    return isValid();
+}
+
+void SeekIndex::addFrame(qint64 sample, qint64 frameSamples, qint64 byteOffset)
+{
+    // 覆盖[sample, sample + frameSamples)内的所有时间刻度
+    while (m_entries.size() * m_intervalSamples < sample + frameSamples) {
+        m_entries.append(Entry{sample, byteOffset});
+    }
+}
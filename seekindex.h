@@ -0,0 +1,47 @@
+#ifndef SEEKINDEX_H
+#define SEEKINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+// 快速定位索引：扫描MP3帧头得到准确时长，并按固定时间间隔记录帧的采样位置和字节偏移；
+// FLAC只读取STREAMINFO（必要时扫描帧）得到准确时长
+class SeekIndex
+{
+public:
+    struct Entry {
+        qint64 sample;      // 帧起始采样位置
+        qint64 byteOffset;  // 帧在文件中的字节偏移
+    };
+
+    static constexpr qint64 INTERVAL_MS = 100;  // 采样表的时间间隔
+
+    // 优先读取磁盘缓存，缓存无效时扫描文件并写回缓存；cancel置位时返回无效索引
+    static SeekIndex loadOrBuild(const QString &filePath, const std::atomic<bool> *cancel = nullptr);
+
+    bool isValid() const { return m_sampleRate > 0 && m_totalSamples > 0; }
+    qint64 durationMs() const;
+    qint64 fileSize() const { return m_fileSize; }
+    // 播放后端按字节比例定位（没有Xing TOC的MP3）时才有采样表
+    bool seeksByByteRatio() const { return !m_entries.isEmpty(); }
+    // 查找起始时间不晚于ms的最近一帧，返回该帧的准确时间和字节偏移
+    bool locate(qint64 ms, qint64 &frameMs, qint64 &byteOffset) const;
+
+private:
+    static SeekIndex build(const QString &filePath, const std::atomic<bool> *cancel);
+    static SeekIndex loadCache(const QString &filePath);
+    bool saveCache(const QString &filePath) const;
+    static QString cachePath(const QString &filePath);
+    bool scanMp3(const uchar *data, qint64 size, const std::atomic<bool> *cancel);
+    bool scanFlac(const uchar *data, qint64 size, const std::atomic<bool> *cancel);
+    void addFrame(qint64 sample, qint64 frameSamples, qint64 byteOffset);
+
+    quint32 m_sampleRate = 0;
+    qint64 m_intervalSamples = 0;
+    qint64 m_totalSamples = 0;
+    qint64 m_fileSize = 0;
+    QVector<Entry> m_entries;       // 第k项为起始位置不晚于k*INTERVAL_MS的最后一帧
+};
+
+#endif // SEEKINDEX_H
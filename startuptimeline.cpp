@@ -0,0 +1,44 @@
+#include "startuptimeline.h"
+
+#include <QDebug>
+
+// 各阶段耗时默认不输出，可用QT_LOGGING_RULES="musicplayer.startup.debug=true"打开；首帧超时警告始终输出
+Q_LOGGING_CATEGORY(lcStartup, "musicplayer.startup", QtInfoMsg)
+
+QElapsedTimer StartupTimeline::s_timer;
+bool StartupTimeline::s_firstFrameMarked = false;
+bool StartupTimeline::s_playableMarked = false;
+
+void StartupTimeline::start()
+{
+    s_timer.start();
+}
+
+void StartupTimeline::mark(const char *stage)
+{
+    qCDebug(lcStartup) << stage << elapsed() << "ms";
+}
+
+void StartupTimeline::markFirstFrame()
+{
+    if (s_firstFrameMarked) return;
+    s_firstFrameMarked = true;
+    qint64 ms = elapsed();
+    qCDebug(lcStartup) << "time-to-first-frame" << ms << "ms";
+    if (ms > FIRST_FRAME_BUDGET_MS) {
+        qCWarning(lcStartup) << "first frame took" << ms << "ms, exceeding budget of"
+                             << FIRST_FRAME_BUDGET_MS << "ms";
+    }
+}
+
+void StartupTimeline::markPlayable()
+{
+    if (s_playableMarked) return;
+    s_playableMarked = true;
+    qCDebug(lcStartup) << "time-to-playable" << elapsed() << "ms";
+}
+
+qint64 StartupTimeline::elapsed()
+{
+    return s_timer.isValid() ? s_timer.elapsed() : 0;
+}
@@ -0,0 +1,27 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(lcStartup)
+
+// 启动时间线：记录从进程启动到各阶段（首帧、可播放）的耗时
+class StartupTimeline
+{
+public:
+    static constexpr qint64 FIRST_FRAME_BUDGET_MS = 150; // 首帧目标耗时
+
+    static void start();                    // 在main()最开始调用
+    static void mark(const char *stage);    // 记录某个阶段完成
+    static void markFirstFrame();           // 记录首帧（只记录一次）
+    static void markPlayable();             // 记录可播放（只记录一次）
+    static qint64 elapsed();
+
+private:
+    static QElapsedTimer s_timer;
+    static bool s_firstFrameMarked;
+    static bool s_playableMarked;
+};
+
+#endif // STARTUPTIMELINE_H
@@ -0,0 +1,147 @@
+#include "taskscheduler.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+
+// 默认只输出info及以上，可用QT_LOGGING_RULES="musicplayer.scheduler.debug=true"打开
+Q_LOGGING_CATEGORY(lcScheduler, "musicplayer.scheduler", QtInfoMsg)
+
+TaskScheduler::TaskScheduler(QObject *parent)
+    : QObject(parent)
+{
+    // 计算线程为GUI线程留出一个核心；I/O线程数量较少，避免机械硬盘上的随机读
+    int cores = QThread::idealThreadCount();
+    m_pools[CpuPool].setMaxThreadCount(qMax(1, cores - 1));
+    m_pools[IoPool].setMaxThreadCount(qBound(2, cores / 2, 4));
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    shutdown();
+}
+
+void TaskScheduler::shutdown()
+{
+    m_shutdown.store(true);
+    for (QThreadPool &pool : m_pools) {
+        pool.clear();
+        pool.waitForDone();
+    }
+    // 被clear()丢弃的任务没有机会递减排队计数，此时剩下的计数都属于它们
+    quint64 dropped = 0;
+    for (std::atomic<int> &queued : m_queued) {
+        dropped += queued.exchange(0);
+    }
+    {
+        QMutexLocker locker(&m_statsMutex);
+        m_cancelled += dropped;
+    }
+    QMutexLocker locker(&m_resultMutex);
+    m_pendingResults.clear();
+}
+
+TaskScheduler::Diagnostics TaskScheduler::diagnostics() const
+{
+    Diagnostics d;
+    for (int i = 0; i < PriorityCount; ++i) {
+        d.queued[i] = m_queued[i].load();
+    }
+    d.running = m_running.load();
+    {
+        QMutexLocker locker(&m_statsMutex);
+        for (int i = 0; i < PriorityCount; ++i) {
+            d.completed[i] = m_completed[i];
+            if (m_completed[i] > 0) {
+                d.avgWaitMs[i] = m_totalWaitMs[i] / m_completed[i];
+                d.avgRunMs[i] = m_totalRunMs[i] / m_completed[i];
+            }
+            d.maxWaitMs[i] = m_maxWaitMs[i];
+        }
+        d.cancelled = m_cancelled;
+    }
+    QMutexLocker locker(&m_resultMutex);
+    d.pendingResults = m_pendingResults.size();
+    return d;
+}
+
+void TaskScheduler::logDiagnostics() const
+{
+    if (!lcScheduler().isDebugEnabled()) return;
+    static const char *names[PriorityCount] = {"current", "next", "background"};
+    Diagnostics d = diagnostics();
+    qCDebug(lcScheduler) << "running" << d.running << "pending results" << d.pendingResults
+                         << "cancelled" << d.cancelled;
+    for (int i = 0; i < PriorityCount; ++i) {
+        qCDebug(lcScheduler) << names[i] << "queued" << d.queued[i] << "done" << d.completed[i]
+                             << "avg wait" << d.avgWaitMs[i] << "ms" << "max wait" << d.maxWaitMs[i] << "ms"
+                             << "avg run" << d.avgRunMs[i] << "ms";
+    }
+}
+
+void TaskScheduler::enqueue(Pool pool, Priority priority, const CancellationToken &token, std::function<void()> job)
+{
+    if (m_shutdown.load()) return;
+    QElapsedTimer queuedTimer;
+    queuedTimer.start();
+    ++m_queued[priority];
+    // QThreadPool中数值越大越先执行
+    m_pools[pool].start([this, priority, token, queuedTimer, job = std::move(job)] {
+        --m_queued[priority];
+        if (token.isCancelled() || m_shutdown.load()) {
+            QMutexLocker locker(&m_statsMutex);
+            ++m_cancelled;
+            return;
+        }
+        qint64 waitMs = queuedTimer.elapsed();
+        QElapsedTimer runTimer;
+        runTimer.start();
+        ++m_running;
+        job();
+        --m_running;
+        recordLatency(priority, waitMs, runTimer.elapsed());
+    }, PriorityCount - priority);
+}
+
+void TaskScheduler::post(const CancellationToken &token, std::function<void()> callback)
+{
+    if (m_shutdown.load()) return;
+    QMutexLocker locker(&m_resultMutex);
+    m_pendingResults.append(PendingResult{token, std::move(callback)});
+    // 已有待处理的交付时只追加，GUI线程一次处理整批结果
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this, &TaskScheduler::flushResults, Qt::QueuedConnection);
+    }
+}
+
+void TaskScheduler::flushResults()
+{
+    QVector<PendingResult> batch;
+    {
+        QMutexLocker locker(&m_resultMutex);
+        batch.swap(m_pendingResults);
+        m_flushScheduled = false;
+    }
+    quint64 dropped = 0;
+    for (PendingResult &result : batch) {
+        if (m_shutdown.load() || result.token.isCancelled()) {
+            ++dropped;
+            continue;
+        }
+        result.callback();
+    }
+    if (dropped > 0) {
+        QMutexLocker locker(&m_statsMutex);
+        m_cancelled += dropped;
+    }
+}
+
+void TaskScheduler::recordLatency(Priority priority, qint64 waitMs, qint64 runMs)
+{
+    QMutexLocker locker(&m_statsMutex);
+    ++m_completed[priority];
+    m_totalWaitMs[priority] += waitMs;
+    m_totalRunMs[priority] += runMs;
+    m_maxWaitMs[priority] = qMax(m_maxWaitMs[priority], waitMs);
+}
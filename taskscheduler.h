@@ -0,0 +1,112 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QMutex>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+Q_DECLARE_LOGGING_CATEGORY(lcScheduler)
+
+// 取消令牌：同一令牌的所有拷贝共享状态，cancel()后排队和未交付的任务都会被丢弃
+class CancellationToken
+{
+public:
+    void cancel() { m_flag->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return m_flag->load(std::memory_order_relaxed); }
+    const std::atomic<bool> *flag() const { return m_flag.get(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_flag = std::make_shared<std::atomic<bool>>(false);
+};
+
+// 后台任务调度器：按优先级在I/O线程池和计算线程池中执行任务，结果分批送回GUI线程
+class TaskScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        CurrentTrack = 0,   // 当前曲目
+        NextTrack,          // 下一首
+        Background,         // 目录遍历等整个曲库的后台任务
+        PriorityCount
+    };
+    Q_ENUM(Priority)
+
+    enum Pool {
+        IoPool = 0,         // 文件读取、目录遍历
+        CpuPool,            // 解析、图片缩放
+        PoolCount
+    };
+    Q_ENUM(Pool)
+
+    struct Diagnostics {
+        int queued[PriorityCount] = {};       // 排队中的任务数
+        int running = 0;                      // 正在执行的任务数
+        quint64 completed[PriorityCount] = {};
+        quint64 cancelled = 0;                // 因令牌失效被丢弃的任务/结果数
+        double avgWaitMs[PriorityCount] = {}; // 从提交到开始执行的平均耗时
+        double avgRunMs[PriorityCount] = {};  // 平均执行耗时
+        qint64 maxWaitMs[PriorityCount] = {};
+        int pendingResults = 0;               // 等待送回GUI线程的结果数
+    };
+
+    explicit TaskScheduler(QObject *parent = nullptr);
+    ~TaskScheduler();
+
+    // 在后台执行work，完成后在GUI线程以work的返回值调用done；令牌失效后两者都可能被跳过
+    template <typename Work, typename Done>
+    void submit(Pool pool, Priority priority, const CancellationToken &token, Work work, Done done)
+    {
+        using Result = std::invoke_result_t<Work>;
+        enqueue(pool, priority, token, [this, token, work = std::move(work), done = std::move(done)]() mutable {
+            Result result = work();
+            if (token.isCancelled()) return;
+            post(token, [done, result = std::move(result)]() mutable {
+                done(std::move(result));
+            });
+        });
+    }
+
+    // 可在任务执行中调用，把中间结果分批交给GUI线程；令牌失效后不再交付
+    void post(const CancellationToken &token, std::function<void()> callback);
+
+    void shutdown();                // 停止交付结果并等待所有线程结束
+    Diagnostics diagnostics() const;
+    void logDiagnostics() const;    // 输出到lcScheduler分类，默认关闭
+
+private:
+    void enqueue(Pool pool, Priority priority, const CancellationToken &token, std::function<void()> job);
+    void flushResults();
+    void recordLatency(Priority priority, qint64 waitMs, qint64 runMs);
+
+    struct PendingResult {
+        CancellationToken token;
+        std::function<void()> callback;
+    };
+
+    QThreadPool m_pools[PoolCount];
+    std::atomic<bool> m_shutdown{false};
+    std::atomic<int> m_queued[PriorityCount] = {};
+    std::atomic<int> m_running{0};
+
+    mutable QMutex m_resultMutex;
+    QVector<PendingResult> m_pendingResults;
+    bool m_flushScheduled = false;
+
+    mutable QMutex m_statsMutex;
+    quint64 m_completed[PriorityCount] = {};
+    quint64 m_cancelled = 0;
+    double m_totalWaitMs[PriorityCount] = {};
+    double m_totalRunMs[PriorityCount] = {};
+    qint64 m_maxWaitMs[PriorityCount] = {};
+};
+
+#endif // TASKSCHEDULER_H